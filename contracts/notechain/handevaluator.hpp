@@ -0,0 +1,508 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+// Poker hands evaluator shared by the contract and native tools.
+// Cards are numbered 0-51: suit is `card / 13`, value is `card % 13` (0 = 2, ..., 12 = A).
+// Lookup tables are generated at compile time (constexpr), so they end up in the data segment
+// and nothing is initialized at runtime.
+namespace hands {
+
+constexpr int getSuit(int card)
+{
+    // 0 = spades
+    // 1 = clubs
+    // 2 = hearts
+    // 3 = diamonds
+    return card / 13;
+}
+constexpr int getValue(int card)
+{
+    // 0 = 2
+    // 1 = 3
+    // ...
+    // 8 = 10
+    // 9 = J
+    // 10 = Q
+    // 11 = K
+    // 12 = A
+    return card % 13;
+}
+constexpr int makeCard(int value, int suit)
+{
+    return suit * 13 + value;
+}
+
+////////////////////////// GENERATED TABLES //////////////////////////
+
+// 5-card subsets of a 7-card hand (indices of selected cards)
+struct fiveofseven
+{
+    int idx[21][5];
+};
+constexpr fiveofseven makeFiveOfSeven()
+{
+    fiveofseven table{};
+    int n = 0;
+    for (int comb = 0; comb < 128; comb++)
+    {
+        int count = 0;
+        for (int i = 0; i < 7; i++)
+            count += (comb >> i) & 1;
+        if (count != 5)
+            continue;
+
+        int k = 0;
+        for (int i = 0; i < 7; i++)
+            if ((comb >> i) & 1)
+                table.idx[n][k++] = i;
+        n++;
+    }
+    return table;
+}
+constexpr fiveofseven FIVE_OF_SEVEN = makeFiveOfSeven();
+
+// rank masks (bit per card value) of all 10 straights, from 5-high (wheel) to A-high
+struct straightmasks
+{
+    int mask[10];
+    int high[10];
+};
+constexpr straightmasks makeStraightMasks()
+{
+    straightmasks table{};
+    // 2,3,4,5,A (ace plays low, straights can't wrap around otherwise)
+    table.mask[0] = 0x100F;
+    table.high[0] = 3;
+    for (int i = 1; i < 10; i++)
+    {
+        table.mask[i] = 0x1F << (i - 1);
+        table.high[i] = i + 3;
+    }
+    return table;
+}
+constexpr straightmasks STRAIGHT_MASKS = makeStraightMasks();
+
+// value of the highest card of the best straight in a rank mask (-1 when there's no straight)
+struct straighttable
+{
+    int8_t high[8192];
+};
+constexpr straighttable makeStraightTable()
+{
+    straighttable table{};
+    for (int mask = 0; mask < 8192; mask++)
+    {
+        table.high[mask] = -1;
+        for (int i = 9; i >= 0; i--)
+        {
+            if ((mask & STRAIGHT_MASKS.mask[i]) == STRAIGHT_MASKS.mask[i])
+            {
+                table.high[mask] = (int8_t)STRAIGHT_MASKS.high[i];
+                break;
+            }
+        }
+    }
+    return table;
+}
+constexpr straighttable STRAIGHT_HIGH = makeStraightTable();
+
+// amount of cards in a rank mask and positions of its highest cards
+// (`nth` packs 4 bits per position: highest card, 2nd, 3rd and 5th highest; 0 when there's no such card)
+struct rankcounts
+{
+    uint8_t count[8192];
+    uint16_t nth[8192];
+};
+constexpr rankcounts makeRankCounts()
+{
+    rankcounts table{};
+    for (int mask = 0; mask < 8192; mask++)
+    {
+        table.count[mask] = (uint8_t)((mask == 0) ? 0 : (table.count[mask >> 1] + (mask & 1)));
+
+        int found = 0;
+        for (int value = 12; value >= 0; value--)
+        {
+            if (!(mask & (1 << value)))
+                continue;
+            found++;
+            if (found <= 3)
+                table.nth[mask] |= (uint16_t)(value << (4 * (found - 1)));
+            else if (found == 5)
+                table.nth[mask] |= (uint16_t)(value << 12);
+        }
+    }
+    return table;
+}
+constexpr rankcounts RANK_COUNTS = makeRankCounts();
+
+// order of a rank mask among all masks with the same amount of cards
+// (flushes and high cards compare highest card first, then the next one and so on,
+// which is exactly how masks with the same popcount compare as numbers)
+struct ranktable
+{
+    uint16_t rank[8192];
+};
+constexpr ranktable makeRankTable()
+{
+    ranktable table{};
+    uint16_t seen[14] = {};
+    for (int mask = 0; mask < 8192; mask++)
+    {
+        table.rank[mask] = seen[RANK_COUNTS.count[mask]];
+        seen[RANK_COUNTS.count[mask]]++;
+    }
+    return table;
+}
+constexpr ranktable KICKER_RANK = makeRankTable();
+
+/////////////////////////// HAND VALUES ///////////////////////////
+
+constexpr int getRankMask(int c0, int c1, int c2, int c3, int c4)
+{
+    return (1 << c0) | (1 << c1) | (1 << c2) | (1 << c3) | (1 << c4);
+}
+constexpr bool isFourOfAKind(int c0, int c1, int c2, int c3, int c4)
+{
+    // optimized version (cards are sorted by value already)
+    if ((c0 == c1)
+        && (c0 == c2)
+        && (c0 == c3))
+        return true;
+
+    if ((c4 == c1)
+        && (c4 == c2)
+        && (c4 == c3))
+        return true;
+
+    return false;
+}
+constexpr bool isFullHouse(int c0, int c1, int c2, int c3, int c4)
+{
+    // 5,5,9,9,9
+    if ((c0 == c1) // 2 of a kind
+        && (c2 == c3) && (c2 == c4)) // 3 of a kind
+        return true;
+
+    // 6,6,6,K,K
+    if ((c0 == c1) && (c0 == c2) // 3 of a kind
+        && (c3 == c4)) // 2 of a kind
+        return true;
+
+    return false;
+}
+constexpr bool isFlush(int c0, int c1, int c2, int c3, int c4)
+{
+    int suit = getSuit(c0);
+    return (suit == getSuit(c1))
+        && (suit == getSuit(c2))
+        && (suit == getSuit(c3))
+        && (suit == getSuit(c4))
+    ;
+}
+constexpr bool isStraight(int c0, int c1, int c2, int c3, int c4)
+{
+    // 5,6,7,8,9
+    // 2,3,4,5,A
+    // 10,J,Q,K,A
+    // straights can't wrap around (2,3,4,K,A is not a straight)
+    return STRAIGHT_HIGH.high[getRankMask(c0, c1, c2, c3, c4)] >= 0;
+}
+constexpr bool isStraightFlush(int c0, int c1, int c2, int c3, int c4, int cv0, int cv1, int cv2, int cv3, int cv4)
+{
+    return isFlush(c0, c1, c2, c3, c4) && isStraight(cv0, cv1, cv2, cv3, cv4);
+}
+
+// Three of a kind
+constexpr bool isThreeOfAKind(int c0, int c1, int c2, int c3, int c4)
+{
+    if ((c0 == c1)
+        && (c0 == c2))
+        return true;
+
+    if ((c1 == c2)
+        && (c1 == c3))
+        return true;
+
+    if ((c2 == c3)
+        && (c2 == c4))
+        return true;
+
+    return false;
+}
+// Two pair
+constexpr bool isTwoPairs(int c0, int c1, int c2, int c3, int c4)
+{
+    if (c0 == c1) // 2,2,3,3,4 or 2,2,3,4,4
+        return ((c2 == c3) || (c3 == c4));
+
+    if (c1 == c2) // 2,3,3,4,4
+        return (c3 == c4);
+
+    return false;
+}
+// Pairs
+constexpr bool isPair(int c0, int c1, int c2, int c3, int c4)
+{
+    return (c0 == c1) || (c1 == c2) || (c2 == c3) || (c3 == c4);
+}
+constexpr int getPairValue(int c0, int c1, int c2, int c3)
+{
+    if (c0 == c1)
+        return c0;
+    if (c1 == c2)
+        return c1;
+    if (c2 == c3)
+        return c2;
+    return c3;
+}
+constexpr int getCombinationValue(int c0, int c1, int c2, int c3, int c4)
+{
+    int cv0 = getValue(c0);
+    int cv1 = getValue(c1);
+    int cv2 = getValue(c2);
+    int cv3 = getValue(c3);
+    int cv4 = getValue(c4);
+    int mask = getRankMask(cv0, cv1, cv2, cv3, cv4);
+
+    // Straight flushes
+    if (isStraightFlush(c0, c1, c2, c3, c4, cv0, cv1, cv2, cv3, cv4))
+        return 1000000
+            + STRAIGHT_HIGH.high[mask] // orders straight flushes on highest card value (2,3,4,5,A loses to 2,3,4,5,6)
+        ;
+
+    // Four of a kind
+    // 5,A,A,A,A
+    // K,A,A,A,A
+    // 6,6,6,6,Q
+    // 6,6,6,6,A
+    if (isFourOfAKind(cv0, cv1, cv2, cv3, cv4))
+        return 900000
+            + 1000 * (cv2 + 1) // get one middle card (there's four of them)
+            + (cv0 + cv4 - cv2) // kicker
+        ;
+
+    // Full Houses
+    if (isFullHouse(cv0, cv1, cv2, cv3, cv4))
+        return 800000
+            + 1000 * (cv2 + 1) // get one middle card (it will always be the one we have 3 of)
+            + (cv0 + cv4 - cv2) // this will be the one we have only 2 of
+        ;
+
+    // Flushes
+    if (isFlush(c0, c1, c2, c3, c4))
+        return 700000
+            + KICKER_RANK.rank[mask] // kickers
+        ;
+
+    // Straights
+    if (isStraight(cv0, cv1, cv2, cv3, cv4))
+        return 600000
+            + STRAIGHT_HIGH.high[mask] // highest card (ace is the lowest one in 2,3,4,5,A)
+        ;
+
+    // Three of a kind
+    if (isThreeOfAKind(cv0, cv1, cv2, cv3, cv4))
+        return 500000
+            + 1000 * (cv2 + 1) // get one middle card (it will always be the one we have 3 of)
+            + KICKER_RANK.rank[mask & ~(1 << cv2)] // kickers (their score will always be lower than main card, but will still help decide)
+        ;
+
+    // Two pair
+    if (isTwoPairs(cv0, cv1, cv2, cv3, cv4))
+        return 400000
+            + 1000 * (cv3 + 1) // highest pair
+            + 50 * (cv1 + 1) // lowest pair
+            + (cv0 + cv2 + cv4 - cv1 - cv3) // voodoo magic! (calculating the kicker)
+        ;
+    // Pairs
+    if (isPair(cv0, cv1, cv2, cv3, cv4))
+        return 300000
+            + 1000 * (getPairValue(cv0, cv1, cv2, cv3) + 1)
+            + KICKER_RANK.rank[mask & ~(1 << getPairValue(cv0, cv1, cv2, cv3))] // kickers
+        ;
+
+    // High cards by rank
+    return KICKER_RANK.rank[mask];
+}
+constexpr int getHighestCombination(int c0, int c1, int c2, int c3, int c4, int c5, int c6)
+{
+    // cards should be sorted by value, every 5-card subset stays sorted then
+    int cards[7] = { c0, c1, c2, c3, c4, c5, c6 };
+    int max = 0;
+    for (int i = 0; i < 21; i++)
+    {
+        const int* idx = FIVE_OF_SEVEN.idx[i];
+        int val = getCombinationValue(cards[idx[0]], cards[idx[1]], cards[idx[2]], cards[idx[3]], cards[idx[4]]);
+        if (val > max)
+            max = val;
+    }
+    return max;
+}
+constexpr int countRanks(int mask)
+{
+    return RANK_COUNTS.count[mask];
+}
+constexpr int getHighestRank(int mask)
+{
+    return RANK_COUNTS.nth[mask] & 0xF;
+}
+constexpr int getSecondRank(int mask)
+{
+    return (RANK_COUNTS.nth[mask] >> 4) & 0xF;
+}
+constexpr int getHighestRanks(int mask, int count)
+{
+    // keeps `count` highest cards of a rank mask (only 1, 2, 3 and 5 cards are stored in the table)
+    int lowest = (RANK_COUNTS.nth[mask] >> (4 * ((count == 5) ? 3 : (count - 1)))) & 0xF;
+    return (mask >> lowest) << lowest;
+}
+constexpr int getSevenCardValue(int c0, int c1, int c2, int c3, int c4, int c5, int c6)
+{
+    /* same value as getHighestCombination, but built directly from rank masks (cards don't need to be sorted) */
+
+    int cards[7] = { c0, c1, c2, c3, c4, c5, c6 };
+    int suits[4] = {};
+    for (int i = 0; i < 7; i++)
+        suits[getSuit(cards[i])] |= 1 << getValue(cards[i]);
+
+    // Straight flushes and flushes
+    // (only 2 cards are left besides a flush, so four of a kind and full house are impossible then)
+    for (int suit = 0; suit < 4; suit++)
+    {
+        if (countRanks(suits[suit]) < 5)
+            continue;
+        if (STRAIGHT_HIGH.high[suits[suit]] >= 0)
+            return 1000000 + STRAIGHT_HIGH.high[suits[suit]];
+        return 700000 + KICKER_RANK.rank[getHighestRanks(suits[suit], 5)];
+    }
+
+    // values we have at least 1, 2, 3 and 4 cards of
+    int ranks = suits[0] | suits[1] | suits[2] | suits[3];
+    int twos = (suits[0] & suits[1]) | (suits[2] & suits[3]) | ((suits[0] | suits[1]) & (suits[2] | suits[3]));
+    int threes = (suits[0] & suits[1] & (suits[2] | suits[3])) | (suits[2] & suits[3] & (suits[0] | suits[1]));
+    int fours = suits[0] & suits[1] & suits[2] & suits[3];
+
+    // Four of a kind
+    if (fours)
+    {
+        int quads = getHighestRank(fours);
+        return 900000 + 1000 * (quads + 1) + getHighestRank(ranks & ~(1 << quads));
+    }
+
+    // Full Houses (second trips plays as a pair)
+    int trips = getHighestRank(threes);
+    int pairs = twos & ~(1 << trips);
+    if (threes && pairs)
+        return 800000 + 1000 * (trips + 1) + getHighestRank(pairs);
+
+    // Straights
+    if (STRAIGHT_HIGH.high[ranks] >= 0)
+        return 600000 + STRAIGHT_HIGH.high[ranks];
+
+    // Three of a kind
+    if (threes)
+        return 500000 + 1000 * (trips + 1) + KICKER_RANK.rank[getHighestRanks(ranks & ~(1 << trips), 2)];
+
+    // Two pair
+    if (countRanks(twos) >= 2)
+    {
+        int pair = getHighestRank(twos);
+        int second_pair = getSecondRank(twos);
+        return 400000 + 1000 * (pair + 1) + 50 * (second_pair + 1) + getHighestRank(ranks & ~(1 << pair) & ~(1 << second_pair));
+    }
+
+    // Pairs
+    if (twos)
+    {
+        int pair = getHighestRank(twos);
+        return 300000 + 1000 * (pair + 1) + KICKER_RANK.rank[getHighestRanks(ranks & ~(1 << pair), 3)];
+    }
+
+    // High cards by rank
+    return KICKER_RANK.rank[getHighestRanks(ranks, 5)];
+}
+inline void sortByValue(std::vector<int>& cards)
+{
+    // evaluator expects cards sorted by value (insertion sort is fine for 7 cards)
+    for (int i = 1; i < (int)cards.size(); i++)
+    {
+        int card = cards[i];
+        int j = i - 1;
+        for (; (j >= 0) && (getValue(cards[j]) > getValue(card)); j--)
+            cards[j + 1] = cards[j];
+        cards[j + 1] = card;
+    }
+}
+inline int getHandValue(const std::vector<int>& board, int pocket0, int pocket1)
+{
+    // best 5-card hand out of 5 board cards and 2 pocket cards
+    return getSevenCardValue(board[0], board[1], board[2], board[3], board[4], pocket0, pocket1);
+}
+
+////////////////////// COMPILE-TIME CHECKS //////////////////////
+
+// values: 0 = 2, ..., 8 = 10, 9 = J, 10 = Q, 11 = K, 12 = A; suits: 0 = spades, 1 = clubs, 2 = hearts, 3 = diamonds
+static_assert(FIVE_OF_SEVEN.idx[0][4] == 4 && FIVE_OF_SEVEN.idx[20][0] == 2, "5-of-7 subsets");
+static_assert(RANK_COUNTS.count[0x1F00] == 5 && getHighestRank(0x0105) == 8 && getHighestRanks(0x1D3F, 5) == 0x1D20, "rank counts");
+static_assert(STRAIGHT_HIGH.high[0x1F00] == 12 && STRAIGHT_HIGH.high[0x100F] == 3 && STRAIGHT_HIGH.high[0x1E01] == -1, "straight masks");
+
+// categories: straight flush > four of a kind > full house > flush > straight > three of a kind > two pair > pair > high card
+static_assert(getCombinationValue(makeCard(8, 0), makeCard(9, 0), makeCard(10, 0), makeCard(11, 0), makeCard(12, 0))
+    > getCombinationValue(makeCard(7, 0), makeCard(12, 0), makeCard(12, 1), makeCard(12, 2), makeCard(12, 3)), "straight flush beats four of a kind");
+static_assert(getCombinationValue(makeCard(0, 0), makeCard(0, 1), makeCard(0, 2), makeCard(0, 3), makeCard(1, 0))
+    > getCombinationValue(makeCard(11, 0), makeCard(11, 1), makeCard(12, 0), makeCard(12, 1), makeCard(12, 2)), "four of a kind beats full house");
+static_assert(getCombinationValue(makeCard(0, 0), makeCard(0, 1), makeCard(1, 0), makeCard(1, 1), makeCard(1, 2))
+    > getCombinationValue(makeCard(6, 2), makeCard(8, 2), makeCard(9, 2), makeCard(10, 2), makeCard(11, 2)), "full house beats flush");
+static_assert(getCombinationValue(makeCard(0, 2), makeCard(1, 2), makeCard(2, 2), makeCard(3, 2), makeCard(5, 2))
+    > getCombinationValue(makeCard(8, 0), makeCard(9, 1), makeCard(10, 2), makeCard(11, 3), makeCard(12, 0)), "flush beats straight");
+static_assert(getCombinationValue(makeCard(0, 0), makeCard(1, 1), makeCard(2, 2), makeCard(3, 3), makeCard(12, 0))
+    > getCombinationValue(makeCard(10, 0), makeCard(11, 1), makeCard(12, 0), makeCard(12, 1), makeCard(12, 2)), "straight beats three of a kind");
+static_assert(getCombinationValue(makeCard(0, 0), makeCard(0, 1), makeCard(0, 2), makeCard(1, 0), makeCard(2, 0))
+    > getCombinationValue(makeCard(10, 0), makeCard(11, 1), makeCard(11, 2), makeCard(12, 0), makeCard(12, 1)), "three of a kind beats two pair");
+static_assert(getCombinationValue(makeCard(0, 0), makeCard(0, 1), makeCard(1, 2), makeCard(1, 0), makeCard(2, 0))
+    > getCombinationValue(makeCard(9, 0), makeCard(10, 1), makeCard(11, 2), makeCard(12, 0), makeCard(12, 1)), "two pair beats pair");
+static_assert(getCombinationValue(makeCard(0, 0), makeCard(0, 1), makeCard(1, 2), makeCard(2, 0), makeCard(3, 0))
+    > getCombinationValue(makeCard(7, 0), makeCard(9, 1), makeCard(10, 2), makeCard(11, 0), makeCard(12, 1)), "pair beats high card");
+
+// orderings inside a category
+static_assert(getCombinationValue(makeCard(0, 0), makeCard(1, 0), makeCard(2, 0), makeCard(3, 0), makeCard(12, 0))
+    < getCombinationValue(makeCard(0, 1), makeCard(1, 1), makeCard(2, 1), makeCard(3, 1), makeCard(4, 1)), "5-high straight flush loses to 6-high");
+static_assert(getCombinationValue(makeCard(0, 0), makeCard(1, 1), makeCard(2, 2), makeCard(3, 3), makeCard(12, 0))
+    < getCombinationValue(makeCard(0, 1), makeCard(1, 1), makeCard(2, 2), makeCard(3, 3), makeCard(4, 0)), "5-high straight loses to 6-high");
+static_assert(getCombinationValue(makeCard(0, 0), makeCard(9, 1), makeCard(10, 2), makeCard(11, 3), makeCard(12, 0))
+    < 600000, "straights don't wrap around");
+static_assert(getCombinationValue(makeCard(0, 0), makeCard(2, 1), makeCard(3, 2), makeCard(4, 3), makeCard(12, 0))
+    > getCombinationValue(makeCard(6, 0), makeCard(7, 1), makeCard(9, 2), makeCard(10, 3), makeCard(11, 0)), "ace high beats king high");
+static_assert(getCombinationValue(makeCard(0, 2), makeCard(2, 2), makeCard(3, 2), makeCard(4, 2), makeCard(12, 2))
+    > getCombinationValue(makeCard(6, 0), makeCard(7, 0), makeCard(9, 0), makeCard(10, 0), makeCard(11, 0)), "ace-high flush beats king-high flush");
+static_assert(getCombinationValue(makeCard(0, 0), makeCard(5, 0), makeCard(5, 1), makeCard(5, 2), makeCard(12, 1))
+    > getCombinationValue(makeCard(5, 0), makeCard(5, 1), makeCard(5, 2), makeCard(10, 0), makeCard(11, 1)), "trips with ace kicker beat trips with king kicker");
+static_assert(getCombinationValue(makeCard(0, 0), makeCard(1, 1), makeCard(2, 2), makeCard(12, 0), makeCard(12, 1))
+    < getCombinationValue(makeCard(0, 0), makeCard(1, 1), makeCard(3, 2), makeCard(12, 2), makeCard(12, 3)), "pair kickers");
+static_assert(getCombinationValue(makeCard(0, 0), makeCard(0, 1), makeCard(11, 2), makeCard(11, 0), makeCard(12, 1))
+    < getCombinationValue(makeCard(9, 0), makeCard(10, 1), makeCard(10, 2), makeCard(11, 0), makeCard(11, 1)), "two pair: second pair decides before kicker");
+static_assert(getCombinationValue(makeCard(5, 0), makeCard(5, 1), makeCard(5, 2), makeCard(5, 3), makeCard(12, 1))
+    > getCombinationValue(makeCard(5, 0), makeCard(5, 1), makeCard(5, 2), makeCard(5, 3), makeCard(11, 1)), "four of a kind kicker");
+static_assert(getCombinationValue(makeCard(0, 0), makeCard(0, 1), makeCard(12, 0), makeCard(12, 1), makeCard(12, 2))
+    > getCombinationValue(makeCard(11, 0), makeCard(11, 1), makeCard(11, 2), makeCard(12, 0), makeCard(12, 1)), "full house: trips decide first");
+
+// best 5 of 7 cards (sorted by value)
+static_assert(getHighestCombination(makeCard(0, 0), makeCard(1, 1), makeCard(2, 2), makeCard(3, 3), makeCard(7, 0), makeCard(11, 1), makeCard(12, 2))
+    == getCombinationValue(makeCard(0, 0), makeCard(1, 1), makeCard(2, 2), makeCard(3, 3), makeCard(12, 2)), "wheel found among 7 cards");
+static_assert(getHighestCombination(makeCard(1, 0), makeCard(4, 0), makeCard(6, 0), makeCard(8, 0), makeCard(9, 1), makeCard(10, 0), makeCard(12, 0))
+    == getCombinationValue(makeCard(4, 0), makeCard(6, 0), makeCard(8, 0), makeCard(10, 0), makeCard(12, 0)), "best flush among 7 cards");
+
+// direct 7-card evaluation matches the best of 21 subsets (cards in any order)
+static_assert(getSevenCardValue(makeCard(12, 2), makeCard(0, 0), makeCard(11, 1), makeCard(1, 1), makeCard(7, 0), makeCard(2, 2), makeCard(3, 3))
+    == getHighestCombination(makeCard(0, 0), makeCard(1, 1), makeCard(2, 2), makeCard(3, 3), makeCard(7, 0), makeCard(11, 1), makeCard(12, 2)), "7 cards: wheel");
+static_assert(getSevenCardValue(makeCard(12, 0), makeCard(9, 1), makeCard(1, 0), makeCard(10, 0), makeCard(4, 0), makeCard(8, 0), makeCard(6, 0))
+    == getHighestCombination(makeCard(1, 0), makeCard(4, 0), makeCard(6, 0), makeCard(8, 0), makeCard(9, 1), makeCard(10, 0), makeCard(12, 0)), "7 cards: flush");
+static_assert(getSevenCardValue(makeCard(5, 0), makeCard(5, 1), makeCard(5, 2), makeCard(9, 0), makeCard(9, 1), makeCard(9, 2), makeCard(12, 3))
+    == getHighestCombination(makeCard(5, 0), makeCard(5, 1), makeCard(5, 2), makeCard(9, 0), makeCard(9, 1), makeCard(9, 2), makeCard(12, 3)), "7 cards: two trips");
+static_assert(getSevenCardValue(makeCard(2, 0), makeCard(2, 1), makeCard(7, 2), makeCard(7, 0), makeCard(11, 1), makeCard(11, 2), makeCard(4, 3))
+    == getHighestCombination(makeCard(2, 0), makeCard(2, 1), makeCard(4, 3), makeCard(7, 2), makeCard(7, 0), makeCard(11, 1), makeCard(11, 2)), "7 cards: three pairs");
+
+} // namespace hands
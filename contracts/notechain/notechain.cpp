@@ -5,9 +5,13 @@
 #include <eosiolib/singleton.hpp>
 #include <eosiolib/time.hpp>
 #include <eosiolib/system.h>
+#include <eosiolib/crypto.h>
 #include <eosio.token/eosio.token.hpp>
 
+#include "handevaluator.hpp"
+
 using namespace eosio;
+using namespace hands;
 
 struct playerpair
 {
@@ -58,10 +62,19 @@ class poker : public eosio::contract
 		eosio::asset alice_bet;
 		eosio::asset bob_bet;
 
+		// money collected from previous betting rounds of the current hand
+		eosio::asset pot;
+
+		// amount of actions made during current betting round
+		uint8_t street_actions;
+
+		// size of the biggest raise during current betting round (next raise can't be smaller)
+		int64_t last_raise;
+
 		// amount of money needed to enter this table
 		eosio::asset buy_in;
 
-		// table cards
+		// table cards (decrypted only at showdown, once somebody shows the hand)
 		vector<checksum256> table_cards;
 
 		// amount of cards that came into play
@@ -74,16 +87,49 @@ class poker : public eosio::contract
 		vector<checksum256> alice_keys;
 		vector<checksum256> bob_keys;
 
+		// sha256 hashes of player private keys committed during shuffle (same layout as keys)
+		vector<checksum256> alice_key_hashes;
+		vector<checksum256> bob_key_hashes;
+		// sha256 over all 53 player private keys concatenated (checks the full reveal in one pass)
+		checksum256 alice_keys_root;
+		checksum256 bob_keys_root;
+
 		// whether the players are ready to play
 		bool alice_ready;
 		bool bob_ready;
 
+		// whether the players have shown their pocket cards at showdown
+		bool alice_shown;
+		bool bob_shown;
+
 		auto primary_key() const { return table_id; }
 	};
 
 	typedef eosio::multi_index< N(rounddata), rounddata
     //   indexed_by< N(getbyuser), const_mem_fun<notestruct, account_name, &notestruct::get_by_user> >
       > rounddatas;
+
+	/// @abi table waitingtable
+	struct waitingtable
+	{
+		uint64_t table_id;
+
+		// player waiting for an opponent
+		account_name alice;
+
+		auto primary_key() const { return table_id; }
+	};
+
+	// tables waiting for the second player, scoped by stake level (only used by game search)
+	typedef eosio::multi_index< N(waitingtable), waitingtable > waitingtables;
+
+	/// @abi table tablecounter
+	struct tablecounter
+	{
+		// id for the next created table (ids are unique across all scopes)
+		uint64_t next_id;
+	};
+	typedef eosio::singleton< N(tablecounter), tablecounter > tablecounters;
 	
 	// we need this struct and table to access eosio.token balances
 	struct account
@@ -94,6 +140,17 @@ class poker : public eosio::contract
 	};
     typedef eosio::multi_index<N(accounts), account> accounts;
 
+	uint64_t stakeScope(const asset& buy_in)
+	{
+		// waiting tables with the same buy-in share one scope
+		return buy_in.amount;
+	}
+	uint64_t tableScope(uint64_t table_id)
+	{
+		// tables are spread over 16 scopes by id, so every action knows the scope without any lookup
+		return table_id % 16;
+	}
+
 	//////////// GAME SEARCH SIMPLIFIED FOR HACKATHON ////////////
 
 	/// @abi action
@@ -101,49 +158,89 @@ class poker : public eosio::contract
 	{
 		/* player searches a suitable table (for hackathon any table is suitable) */
 
-		rounddatas datas(_self, _self);
+		// table buy-in is hardcoded for the duration of hackathon
+		asset buy_in(1000, CORE_SYMBOL);
 
-		for (auto table_it = datas.begin(); table_it != datas.end(); ++table_it)
+		// only tables of our stake level that wait for a player are scanned
+		waitingtables waiting(_self, stakeScope(buy_in));
+
+		for (auto waiting_it = waiting.begin(); waiting_it != waiting.end(); ++waiting_it)
 		{
-			if (table_it->state != WAITING_FOR_PLAYERS)
-			{
-				// skip already playing tables
-				continue;
-			}
-			if (table_it->alice == _self)
+			if (waiting_it->alice == _self)
 			{
 				// can't play with myself
 				continue;
 			}
-			if (table_it->bob == account_name())
-			{
-				// found suitable table, let's join it
 
-				datas.modify(table_it, _self, [&]( auto& table ) {
-					table.bob = _self;
-					table.state = TABLE_READY;
-				});
+			// found suitable table, let's join it
+			rounddatas datas(_self, tableScope(waiting_it->table_id));
 
-				return;
-			}
+			auto table_it = datas.find(waiting_it->table_id);
+			assert(table_it != datas.end());
+			datas.modify(table_it, _self, [&]( auto& table ) {
+				table.bob = _self;
+				table.state = TABLE_READY;
+			});
+			waiting.erase(waiting_it);
+
+			return;
 		}
 		
 		// couldn't find suitable table, let's create a new one
-		
+
+		tablecounters counter(_self, _self);
+		tablecounter next = counter.get_or_default(tablecounter());
+		uint64_t table_id = next.next_id;
+		next.next_id = table_id + 1;
+		counter.set(next, _self);
+
+		rounddatas datas(_self, tableScope(table_id));
 		datas.emplace(_self, [&]( auto& table ) {
-			table.table_id = datas.available_primary_key();
+			table.table_id = table_id;
 			table.alice = _self;
 			table.state = WAITING_FOR_PLAYERS;
-			// table buy-in is hardcoded for the duration of hackathon
-			table.buy_in = asset(1000, CORE_SYMBOL);
+			table.buy_in = buy_in;
         });
+		waiting.emplace(_self, [&]( auto& entry ) {
+			entry.table_id = table_id;
+			entry.alice = _self;
+		});
+	}
+	void updateWaiting(const rounddata& table)
+	{
+		/* keeps the waiting tables index in sync after a player has left the table */
+
+		waitingtables waiting(_self, stakeScope(table.buy_in));
+
+		auto waiting_it = waiting.find(table.table_id);
+		if (table.alice == account_name())
+		{
+			// nobody is left at the table, it can't be found anymore
+			if (waiting_it != waiting.end())
+			{
+				waiting.erase(waiting_it);
+			}
+		}
+		else if (waiting_it == waiting.end())
+		{
+			waiting.emplace(_self, [&]( auto& entry ) {
+				entry.table_id = table.table_id;
+				entry.alice = table.alice;
+			});
+		}
+		else
+		{
+			waiting.modify(waiting_it, _self, [&]( auto& entry ) {
+				entry.alice = table.alice;
+			});
+		}
 	}
 
 	/// @abi action
 	void cancel_game(uint64_t table_id)
 	{
 		/* cancel game before the start */
-		rounddatas datas(_self, _self);
+		rounddatas datas(_self, tableScope(table_id));
 
 		auto table_it = datas.find(table_id);
 		assert(table_it != datas.end());
@@ -171,12 +268,13 @@ class poker : public eosio::contract
 				table.bob_ready = false;
 			});
 		}
+		updateWaiting(*table_it);
 	}
 
     /// @abi action
     void start_game(uint64_t table_id)
 	{
-		rounddatas datas(_self, _self);
+		rounddatas datas(_self, tableScope(table_id));
 
 		auto table_it = datas.find(table_id);
 		assert(table_it != datas.end());
@@ -208,6 +306,17 @@ class poker : public eosio::contract
 				table.cards_dealt = 0;
 				table.alice_keys = vector<checksum256>(53);
 				table.bob_keys = vector<checksum256>(53);
+				table.table_cards = vector<checksum256>();
+				table.alice_shown = false;
+				table.bob_shown = false;
+				// both players sit down with the whole buy-in
+				table.alice_bankroll = table.buy_in;
+				table.bob_bankroll = table.buy_in;
+				table.alice_bet = asset(0, table.buy_in.symbol);
+				table.bob_bet = asset(0, table.buy_in.symbol);
+				table.pot = asset(0, table.buy_in.symbol);
+				table.street_actions = 0;
+				table.last_raise = 0;
 			});
 		}
 		// now we should hold the bankroll amount of money on user account (hard-coded for now)
@@ -250,20 +359,31 @@ class poker : public eosio::contract
 		// xor card with pk
 		return card;
 	}
+	void assertKeyCommitment(const vector<checksum256>& key_hashes, uint8_t key_idx, const checksum256& key)
+	{
+		/* checks revealed key against the hash committed during shuffle */
+
+		// there is nothing to check against before shuffle
+		assert(key_hashes.size() == 53);
+		assert_sha256((char*)&key, sizeof(checksum256), &key_hashes[key_idx]);
+	}
 
 	///////////////////////// SHUFFLING METHODS ////////////////////////////
 
 	/// @abi action
-	void deck_shuffled(uint64_t table_id, vector<checksum256> encrypted_cards)
+	void deck_shuffled(uint64_t table_id, vector<checksum256> encrypted_cards, vector<checksum256> key_hashes, checksum256 keys_root)
 	{
-		/* player pushes shuffled & encrypted deck */
+		/* player pushes shuffled & encrypted deck along with hashes of all their private keys (PK_0, PK_1-PK_52) */
+		/* and one hash over all the keys together */
 
-		rounddatas datas(_self, _self);
+		rounddatas datas(_self, tableScope(table_id));
 
 		auto table_it = datas.find(table_id);
 		assert(table_it != datas.end());
 		assert(table_it->state == SHUFFLE);
+		assert(encrypted_cards.size() == 52);
 		assert(_self == table_it->target);
+		assert(key_hashes.size() == 53);
 
 		if (_self == table_it->alice)
 		{
@@ -272,6 +392,8 @@ class poker : public eosio::contract
 				// table.state = SHUFFLE; // state doesn't change
 				table.target = table.bob;
 				table.encrypted_cards = encrypted_cards;
+				table.alice_key_hashes = key_hashes;
+				table.alice_keys_root = keys_root;
 			});
 		}
 		else
@@ -281,6 +403,8 @@ class poker : public eosio::contract
 				table.state = RECRYPT;
 				table.target = table.alice;
 				table.encrypted_cards = encrypted_cards;
+				table.bob_key_hashes = key_hashes;
+				table.bob_keys_root = keys_root;
 			});
 		}
 	}
@@ -289,11 +413,12 @@ class poker : public eosio::contract
 	{
 		/* player pushes re-encrypted deck */
 
-		rounddatas datas(_self, _self);
+		rounddatas datas(_self, tableScope(table_id));
 
 		auto table_it = datas.find(table_id);
 		assert(table_it != datas.end());
 		assert(table_it->state == RECRYPT);
+		assert(encrypted_cards.size() == 52);
 		assert(_self == table_it->target);
 
 		if (_self == table_it->alice)
@@ -321,46 +446,46 @@ class poker : public eosio::contract
 	{
 		/* receive next card private key from player */
 		
-		rounddatas datas(_self, _self);
+		rounddatas datas(_self, tableScope(table_id));
 
 		auto table_it = datas.find(table_id);
 		assert(table_it != datas.end());
 		assert((table_it->state == DEAL_TABLE) || (table_it->state == DEAL_POCKET));
 		assert((_self == table_it->alice) || (_self == table_it->bob));
+
+		// key should match the commitment made during shuffle
+		assertKeyCommitment((_self == table_it->alice) ? table_it->alice_key_hashes : table_it->bob_key_hashes, table_it->cards_dealt + 1, key);
+
 		if (table_it->state == DEAL_POCKET)
 		{
 			// we're dealing pocket cards
 			
 			assert(_self != table_it->target); // we should not send encryption keys for our own cards
 
-			if (_self == table_it->alice)
-			{
-				datas.modify(table_it, _self, [&](auto& table) {
-					// save the key for later use in decryption
+			datas.modify(table_it, _self, [&](auto& table) {
+				// save the key for later use in decryption
+				if (_self == table.alice)
+				{
 					table.alice_keys[table.cards_dealt + 1] = key;
-
-					table.cards_dealt = table.cards_dealt + 1;
-
-					table.target = table.bob;
-				});
-			}
-			else
-			{
-				datas.modify(table_it, _self, [&](auto& table) {
-					// save the key for later use in decryption
+				}
+				else
+				{
 					table.bob_keys[table.cards_dealt + 1] = key;
+				}
 
-					table.cards_dealt = table.cards_dealt + 1;
+				table.cards_dealt = table.cards_dealt + 1;
 
-					table.target = table.alice;
+				// cards are dealt in turns (alice gets cards 1 and 3, bob gets cards 2 and 4),
+				// so the next card goes to the player who just sent the key
+				table.target = _self;
 
-					if (table.cards_dealt == 4) // hardcoded pocket cards count (2 players with 2 pocket cards each)
-					{
-						// we dealt 2 cards to each player, starting betting round
-						table.state = BET_ROUND;
-					}
-				});
-			}
+				if (table.cards_dealt == 4) // hardcoded pocket cards count (2 players with 2 pocket cards each)
+				{
+					// we dealt 2 cards to each player, starting betting round
+					table.state = BET_ROUND;
+					postBlinds(table);
+				}
+			});
 		}
 		else
 		{
@@ -409,8 +534,16 @@ class poker : public eosio::contract
 						// it's either flop, turn, or river
 						// we don't burn card like they do in casinos, it has no effect on randomness
 						// but we can burn it if we decide to
-						table.state = BET_ROUND;
-						table.target = table.target; // there's a little mess with turn order, but we have no more hackathon time to fix it
+						if ((table.alice_bankroll.amount == 0) || (table.bob_bankroll.amount == 0))
+						{
+							// somebody is all-in, there's nothing to bet anymore, deal until the river
+							table.state = (table.cards_dealt < 9) ? DEAL_TABLE : SHOWDOWN;
+						}
+						else
+						{
+							table.state = BET_ROUND;
+							table.target = table.bob; // big blind acts first after the flop
+						}
 					}
 				});
 			}
@@ -419,12 +552,75 @@ class poker : public eosio::contract
 	
 	//////////////////////// POKER GAME LOGIC METHODS ////////////////////////////
 	
+	int64_t bigBlind(const rounddata& table)
+	{
+		// blinds are derived from the buy-in (every player starts with 50 big blinds)
+		return table.buy_in.amount / 50;
+	}
+	void postBlinds(rounddata& table)
+	{
+		/* alice is the button and posts the small blind, bob posts the big blind */
+		/* (heads-up rules: button acts first before the flop and last after it) */
+
+		int64_t bb = bigBlind(table);
+		bb = (bb < table.bob_bankroll.amount) ? bb : table.bob_bankroll.amount;
+		int64_t sb = bigBlind(table) / 2;
+		sb = (sb < bb) ? sb : bb;
+		sb = (sb < table.alice_bankroll.amount) ? sb : table.alice_bankroll.amount;
+
+		table.alice_bankroll.amount -= sb;
+		table.alice_bet.amount = sb;
+		table.bob_bankroll.amount -= bb;
+		table.bob_bet.amount = bb;
+		table.street_actions = 0;
+		table.last_raise = bigBlind(table);
+		table.target = table.alice;
+	}
+	void endStreet(rounddata& table)
+	{
+		/* both bets are matched, move them to the pot and proceed to the next street */
+
+		table.pot.amount += table.alice_bet.amount + table.bob_bet.amount;
+		table.alice_bet.amount = 0;
+		table.bob_bet.amount = 0;
+		table.street_actions = 0;
+		table.last_raise = 0;
+		if (table.cards_dealt < 9) // magic number 9 is `2(alice cards) + 2(bob cards) + 3 (flop cards) + 1 (turn card) + 1 (river card)`
+		{
+			table.state = DEAL_TABLE;
+		}
+		else
+		{
+			// calculate winner!
+			table.state = SHOWDOWN;
+		}
+	}
+	void awardPot(rounddata& table, account_name winner)
+	{
+		/* give all the money on the table to the winner and finish the hand */
+
+		int64_t total = table.pot.amount + table.alice_bet.amount + table.bob_bet.amount;
+		if (winner == table.alice)
+		{
+			table.alice_bankroll.amount += total;
+		}
+		else
+		{
+			table.bob_bankroll.amount += total;
+		}
+		table.pot.amount = 0;
+		table.alice_bet.amount = 0;
+		table.bob_bet.amount = 0;
+		table.street_actions = 0;
+		table.state = END;
+	}
+
 	/// @abi action
 	void check(uint64_t table_id)
 	{
 		/* `check` (do not raise bet, do not fold cards) */
 
-		rounddatas datas(_self, _self);
+		rounddatas datas(_self, tableScope(table_id));
 
 		auto table_it = datas.find(table_id);
 		assert(table_it != datas.end());
@@ -432,65 +628,289 @@ class poker : public eosio::contract
 		assert(_self == table_it->target);
 
 		// we can check only if bets are equal
-		assert(table_it->alice_bet == table_it->bob_bet);
+		assert(table_it->alice_bet.amount == table_it->bob_bet.amount);
 
-		if (_self == table_it->alice)
-		{
-			// first action, let the other one decide
-			datas.modify(table_it, _self, [&](auto& table) {
-				table.target = table.bob;
-			});
-		}
-		else
-		{
-			datas.modify(table_it, _self, [&](auto& table) {
-				if (table.cards_dealt < 9) // magic number 9 is `2(alice cards) + 2(bob cards) + 3 (flop cards) + 1 (turn card) + 1 (river card)`
-				{
-					table.state = DEAL_TABLE;
-				}
-				else
-				{
-					// calculate winner!
-					table.state = SHOWDOWN;
-				}
-			});
-		}
+		datas.modify(table_it, _self, [&](auto& table) {
+			table.street_actions = table.street_actions + 1;
+			if (table.street_actions < 2)
+			{
+				// first action, let the other one decide
+				table.target = (_self == table.alice) ? table.bob : table.alice;
+			}
+			else
+			{
+				endStreet(table);
+			}
+		});
 	}
 	/// @abi action
 	void call(uint64_t table_id)
 	{
 		/* `call` (raise bet to match opponent raised bet) */
 
-		rounddatas datas(_self, _self);
+		rounddatas datas(_self, tableScope(table_id));
 
 		auto table_it = datas.find(table_id);
 		assert(table_it != datas.end());
 		assert(table_it->state == BET_ROUND);
 		assert(_self == table_it->target);
+
+		bool is_alice = (_self == table_it->alice);
+
+		// there should be something to call (use `check` otherwise)
+		assert(is_alice ? (table_it->bob_bet.amount > table_it->alice_bet.amount) : (table_it->alice_bet.amount > table_it->bob_bet.amount));
+
+		datas.modify(table_it, _self, [&](auto& table) {
+			int64_t& my_bankroll = is_alice ? table.alice_bankroll.amount : table.bob_bankroll.amount;
+			int64_t& my_bet = is_alice ? table.alice_bet.amount : table.bob_bet.amount;
+			int64_t& opponent_bankroll = is_alice ? table.bob_bankroll.amount : table.alice_bankroll.amount;
+			int64_t& opponent_bet = is_alice ? table.bob_bet.amount : table.alice_bet.amount;
+
+			int64_t to_call = opponent_bet - my_bet;
+			if (to_call > my_bankroll)
+			{
+				// not enough money to call, we go all-in and the uncalled part of the bet goes back
+				// (with two players that's the whole side pot)
+				opponent_bankroll += to_call - my_bankroll;
+				opponent_bet -= to_call - my_bankroll;
+				to_call = my_bankroll;
+			}
+			my_bankroll -= to_call;
+			my_bet += to_call;
+
+			table.street_actions = table.street_actions + 1;
+			if ((my_bankroll == 0) || (opponent_bankroll == 0) || (table.street_actions >= 2))
+			{
+				// bets are matched (small blind calling pre-flop still leaves the big blind an option)
+				endStreet(table);
+			}
+			else
+			{
+				table.target = is_alice ? table.bob : table.alice;
+			}
+		});
 	}
 	/// @abi action
 	void raise(uint64_t table_id, eosio::asset amount)
 	{
 		/* `raise` bet (no more than current player bankroll) */
 
-		rounddatas datas(_self, _self);
+		rounddatas datas(_self, tableScope(table_id));
 
 		auto table_it = datas.find(table_id);
 		assert(table_it != datas.end());
 		assert(table_it->state == BET_ROUND);
 		assert(_self == table_it->target);
+		assert(amount.symbol == table_it->buy_in.symbol);
+		assert(amount.amount > 0);
+
+		bool is_alice = (_self == table_it->alice);
+		int64_t my_bankroll = is_alice ? table_it->alice_bankroll.amount : table_it->bob_bankroll.amount;
+		int64_t to_call = is_alice ? (table_it->bob_bet.amount - table_it->alice_bet.amount) : (table_it->alice_bet.amount - table_it->bob_bet.amount);
+
+		// opponent is all-in, there's nobody to raise against
+		assert((is_alice ? table_it->bob_bankroll.amount : table_it->alice_bankroll.amount) > 0);
+		// we can't bet more than we have
+		assert(to_call + amount.amount <= my_bankroll);
+		// raise should be at least one big blind and no less than the previous raise unless we go all-in
+		int64_t min_raise = (table_it->last_raise > bigBlind(*table_it)) ? table_it->last_raise : bigBlind(*table_it);
+		assert((amount.amount >= min_raise) || (to_call + amount.amount == my_bankroll));
+
+		datas.modify(table_it, _self, [&](auto& table) {
+			if (is_alice)
+			{
+				table.alice_bankroll.amount -= to_call + amount.amount;
+				table.alice_bet.amount += to_call + amount.amount;
+				table.target = table.bob;
+			}
+			else
+			{
+				table.bob_bankroll.amount -= to_call + amount.amount;
+				table.bob_bet.amount += to_call + amount.amount;
+				table.target = table.alice;
+			}
+			table.street_actions = table.street_actions + 1;
+			if (amount.amount > table.last_raise)
+			{
+				// short all-in doesn't lower the minimum raise
+				table.last_raise = amount.amount;
+			}
+		});
 	}
 	/// @abi action
 	void fold(uint64_t table_id)
 	{
 		/* `fold` (drop cards, stop playing current round) */
-		
-		rounddatas datas(_self, _self);
+
+		rounddatas datas(_self, tableScope(table_id));
 
 		auto table_it = datas.find(table_id);
 		assert(table_it != datas.end());
 		assert(table_it->state == BET_ROUND);
 		assert(_self == table_it->target);
+
+		datas.modify(table_it, _self, [&](auto& table) {
+			// opponent takes everything on the table
+			awardPot(table, (_self == table.alice) ? table.bob : table.alice);
+		});
+	}
+
+	///////////////////////// SHOWDOWN METHODS ////////////////////////////
+
+	checksum256 decryptCard(const rounddata& table, uint8_t card_idx)
+	{
+		/* removes both players' encryption layers from the card (PK_1-PK_52 go with cards 1-52) */
+		return decrypt(decrypt(table.encrypted_cards[card_idx - 1], table.alice_keys[card_idx]), table.bob_keys[card_idx]);
+	}
+	int cardFromPlaintext(const checksum256& plaintext)
+	{
+		// decrypted card carries its number (0-51) in the first byte
+		assert(plaintext.hash[0] < 52);
+		return plaintext.hash[0];
+	}
+	uint8_t pocketCardIdx(const rounddata& table, account_name player, uint8_t n)
+	{
+		// pocket cards are dealt one by one: alice gets cards 1 and 3, bob gets cards 2 and 4
+		return (player == table.alice) ? (1 + 2 * n) : (2 + 2 * n);
+	}
+	bool boardPlays(const vector<int>& board)
+	{
+		/* checks whether no pocket cards can improve the board (both players have the same hand) */
+
+		int value = getCombinationValue(board[0], board[1], board[2], board[3], board[4]);
+
+		// royal flush on the table
+		if (value == 1000000 + 12)
+			return true;
+
+		// four of a kind with the highest possible kicker
+		// (board holds at most 2 cards of one suit, so there's no straight flush to draw to)
+		if ((value >= 900000) && (value < 1000000))
+		{
+			int quads = getValue(board[2]);
+			int kicker = getValue(board[0]) + getValue(board[4]) - quads;
+			return kicker == ((quads == 12) ? 11 : 12);
+		}
+
+		return false;
+	}
+	void splitPot(rounddata& table)
+	{
+		/* both players have the same hand, odd chip goes to the player out of position (bob) */
+
+		int64_t total = table.pot.amount + table.alice_bet.amount + table.bob_bet.amount;
+		table.alice_bankroll.amount += total / 2;
+		table.bob_bankroll.amount += total - total / 2;
+		table.pot.amount = 0;
+		table.alice_bet.amount = 0;
+		table.bob_bet.amount = 0;
+		table.street_actions = 0;
+		table.state = END;
+	}
+	vector<int> getBoard(rounddata& table)
+	{
+		if (table.table_cards.empty())
+		{
+			// board is decrypted once and cached for the rest of the showdown
+			// (magic number 5 is the first board card: 4 pocket cards go before it)
+			for (uint8_t card_idx = 5; card_idx <= 9; card_idx++)
+				table.table_cards.push_back(decryptCard(table, card_idx));
+		}
+
+		vector<int> board = vector<int>(5);
+		for (int i = 0; i < 5; i++)
+			board[i] = cardFromPlaintext(table.table_cards[i]);
+		sortByValue(board);
+		return board;
+	}
+	void settleShowdown(rounddata& table)
+	{
+		/* both hands are shown, decrypt pocket cards and compare the hands */
+
+		vector<int> board = getBoard(table);
+
+		int alice_value = getHandValue(board,
+			cardFromPlaintext(decryptCard(table, pocketCardIdx(table, table.alice, 0))),
+			cardFromPlaintext(decryptCard(table, pocketCardIdx(table, table.alice, 1))));
+		int bob_value = getHandValue(board,
+			cardFromPlaintext(decryptCard(table, pocketCardIdx(table, table.bob, 0))),
+			cardFromPlaintext(decryptCard(table, pocketCardIdx(table, table.bob, 1))));
+
+		if (alice_value == bob_value)
+		{
+			splitPot(table);
+		}
+		else
+		{
+			awardPot(table, (alice_value > bob_value) ? table.alice : table.bob);
+		}
+	}
+
+	/// @abi action
+	void show_hand(uint64_t table_id, checksum256 first_key, checksum256 second_key)
+	{
+		/* player reveals private keys of their own pocket cards */
+
+		rounddatas datas(_self, tableScope(table_id));
+
+		auto table_it = datas.find(table_id);
+		assert(table_it != datas.end());
+		assert(table_it->state == SHOWDOWN);
+		assert((_self == table_it->alice) || (_self == table_it->bob));
+
+		bool is_alice = (_self == table_it->alice);
+		uint8_t first_idx = pocketCardIdx(*table_it, _self, 0);
+		uint8_t second_idx = pocketCardIdx(*table_it, _self, 1);
+
+		// hand can be shown only once
+		assert(!(is_alice ? table_it->alice_shown : table_it->bob_shown));
+		// both keys should match the commitments made during shuffle
+		const vector<checksum256>& key_hashes = is_alice ? table_it->alice_key_hashes : table_it->bob_key_hashes;
+		assertKeyCommitment(key_hashes, first_idx, first_key);
+		assertKeyCommitment(key_hashes, second_idx, second_key);
+
+		bool opponent_shown = is_alice ? table_it->bob_shown : table_it->alice_shown;
+
+		datas.modify(table_it, _self, [&](auto& table) {
+			vector<checksum256>& my_keys = is_alice ? table.alice_keys : table.bob_keys;
+			my_keys[first_idx] = first_key;
+			my_keys[second_idx] = second_key;
+			if (is_alice)
+			{
+				table.alice_shown = true;
+			}
+			else
+			{
+				table.bob_shown = true;
+			}
+
+			if (opponent_shown)
+			{
+				// both hands are open, we can calculate the winner
+				settleShowdown(table);
+			}
+			else if (boardPlays(getBoard(table)))
+			{
+				// nobody can beat the board, no need to wait for the other hand or decrypt any pocket card
+				splitPot(table);
+			}
+		});
+	}
+	/// @abi action
+	void muck(uint64_t table_id)
+	{
+		/* give up at showdown without showing the cards, no card gets decrypted */
+
+		rounddatas datas(_self, tableScope(table_id));
+
+		auto table_it = datas.find(table_id);
+		assert(table_it != datas.end());
+		assert(table_it->state == SHOWDOWN);
+		assert((_self == table_it->alice) || (_self == table_it->bob));
+
+		datas.modify(table_it, _self, [&](auto& table) {
+			awardPot(table, (_self == table.alice) ? table.bob : table.alice);
+		});
 	}
 
 	///////////////////// DISPUTES & CHEATING DETECTION ////////////////////
@@ -506,6 +926,27 @@ class poker : public eosio::contract
 	{
 		/* Receives all card encryption private keys from the player to check for cheating. */
 
+		rounddatas datas(_self, tableScope(table_id));
+
+		auto table_it = datas.find(table_id);
+		assert(table_it != datas.end());
+		assert(table_it->state == END); // keys can't be replaced in the middle of a hand
+		assert((_self == table_it->alice) || (_self == table_it->bob));
+		assert(private_keys.size() == 53);
+
+		// player that reveals keys different from the committed ones is caught right here (single hash over all keys)
+		assert_sha256((char*)private_keys.data(), 53 * sizeof(checksum256), (_self == table_it->alice) ? &table_it->alice_keys_root : &table_it->bob_keys_root);
+
+		datas.modify(table_it, _self, [&](auto& table) {
+			if (_self == table.alice)
+			{
+				table.alice_keys = private_keys;
+			}
+			else
+			{
+				table.bob_keys = private_keys;
+			}
+		});
 	}
 	/// @abi action
 	void dispute_step(uint64_t table_id, uint8_t step_idx)
@@ -514,277 +955,6 @@ class poker : public eosio::contract
 			(players can do their calculation off-chain and then check just one). */
 		
 	}
-
-	///////////////////// POKER HANDS EVALUATOR ///////////////////////
-	bool hasFlag(int b1, int b2)
-    {
-	// should be bitwise operation
-        return (b1 / b2) % 2 == 1;
-    }
-	int getSuit(int card)
-    {
-        // 0 = spades
-        // 1 = clubs
-        // 2 = hearts
-        // 3 = diamonds
-        return card / 13;
-    }
-    int getValue(int card)
-    {
-        // 0 = 2
-        // 1 = 3
-        // ...
-        // 8 = 10
-        // 9 = J
-        // 10 = Q
-        // 11 = K
-        // 12 = A
-        return card % 13;
-    }
-	vector<int> selectCombination(int c0, int c1, int c2, int c3, int c4, int c5, int c6, int comb)
-    {
-        vector<int> select = vector<int>();
-        if (hasFlag(comb, 1))
-			select.push_back(c0);
-        if (hasFlag(comb, 2))
-			select.push_back(c1);
-        if (hasFlag(comb, 4))
-			select.push_back(c2);
-        if (hasFlag(comb, 8))
-			select.push_back(c3);
-        if (hasFlag(comb, 16))
-			select.push_back(c4);
-        if (hasFlag(comb, 32))
-			select.push_back(c5);
-        if (hasFlag(comb, 64))
-			select.push_back(c6);
-        
-        return select;
-    }
-    int getHighestCombination(int c0, int c1, int c2, int c3, int c4, int c5, int c6)
-    {
-		vector<int> cardCombinations = vector<int>{
-			31, 47, 79, 55, 87, 103, 59, 91, 107, 115, 61, 93, 109, 117, 121, 62, 94, 110, 118, 122, 124
-			// magic numbers! (different permutations of a 7-card array on a 5-card hand)
-		};
-        int max = 0;
-        for (int i = 0; i < 21; i++)
-        {
-            auto combination = selectCombination(c0, c1, c2, c3, c4, c5, c6, cardCombinations[i]);
-            int cc0 = combination[0];
-            int cc1 = combination[1];
-            int cc2 = combination[2];
-            int cc3 = combination[3];
-            int cc4 = combination[4];
-            int val = getCombinationValue(cc0, cc1, cc2, cc3, cc4);
-            if (val > max)
-                max = val;
-        }
-        return max;
-    }
-	int getCombinationValue(int c0, int c1, int c2, int c3, int c4)
-    {
-        int cv0 = getValue(c0);
-        int cv1 = getValue(c1);
-        int cv2 = getValue(c2);
-        int cv3 = getValue(c3);
-        int cv4 = getValue(c4);
-
-        // Straight flushes
-        if (isStraightFlush(c0, c1, c2, c3, c4, cv0, cv1, cv2, cv3, cv4))
-            return 1000000
-                + cv0 // orders straight flushes on highest card value (2,J,Q,K,A loses to 2,3,4,5,6)
-            ;
-        
-        // Four of a kind
-        // 5,A,A,A,A
-        // K,A,A,A,A
-        // 6,6,6,6,Q
-        // 6,6,6,6,A
-        if (isFourOfAKind(cv0, cv1, cv2, cv3, cv4))
-            return 900000
-                + 1000 * (cv2 + 1) // get one middle card (there's four of them)
-                + (cv0 + cv4 - cv2) // kicker
-            ;
-
-        // Full Houses
-        if (isFullHouse(cv0, cv1, cv2, cv3, cv4))
-            return 800000
-                + 1000 * (cv2 + 1) // get one middle card (it will always be the one we have 3 of)
-                + (cv0 + cv4 - cv2) // this will be the one we have only 2 of
-            ;
-        
-        // Flushes
-        if (isFlush(c0, c1, c2, c3, c4))
-            return 700000
-                + 5 * cv4 // kickers
-                + 4 * cv3
-                + 3 * cv2
-                + 2 * cv1
-                + 1 * cv0
-            ;
-        
-        // Straights
-        if (isStraight(cv0, cv1, cv2, cv3, cv4))
-            return 600000
-                + cv4 // highest card
-            ;
-        
-        // Three of a kind
-        if (isThreeOfAKind(cv0, cv1, cv2, cv3, cv4))
-            return 500000
-                + 1000 * (cv2 + 1) // get one middle card (it will always be the one we have 3 of)
-                + 5 * cv4 // kickers (their score will always be lower than main card, but will still help decide)
-                + 4 * cv3
-                + 3 * cv2
-                + 2 * cv1
-                + 1 * cv0
-            ;
-
-        // Two pair
-        if (isTwoPairs(cv0, cv1, cv2, cv3, cv4))
-            return 400000
-                + 1000 * (cv3 + 1) // highest pair
-                + 50 * (cv1 + 1) // lowest pair
-                + (cv0 + cv2 + cv4 - cv1 - cv3) // voodoo magic! (calculating the kicker)
-            ;
-        // Pairs
-        if (isPair(cv0, cv1, cv2, cv3, cv4))
-            return 300000
-                + getPairCoef(cv0, cv1, cv2, cv3, cv4)
-            ;
-
-        // High cards by rank
-        return 5 * cv4 + 4 * cv3 + 3 * cv2 + 2 * cv1 + cv0;
-    }
-    int getPairCoef(int c0, int c1, int c2, int c3, int c4)
-    {
-        if (c0 == c1)
-            return 1000 * (c0 + 1) + 5 * c4 + 4 * c3 + 3 * c2;
-        if (c1 == c2)
-            return 1000 * (c1 + 1) + 5 * c4 + 4 * c3 + 1 * c0;
-        if (c2 == c3)
-            return 1000 * (c2 + 1) + 5 * c4 + 2 * c1 + 1 * c0;
-        if (c3 == c4)
-            return 1000 * (c4 + 1) + 3 * c2 + 2 * c1 + 1 * c0;
-        
-        return 0;
-    }
-	bool isFourOfAKind(int c0, int c1, int c2, int c3, int c4)
-    {
-        // optimized version (cards are sorted by value already)
-        if ((c0 == c1)
-            && (c0 == c2)
-            && (c0 == c3))
-            return true;
-        
-        if ((c4 == c1)
-            && (c4 == c2)
-            && (c4 == c3))
-            return true;
-        
-        return false;
-    }
-    bool isFullHouse(int c0, int c1, int c2, int c3, int c4)
-    {
-        // 5,5,9,9,9
-        if ((c0 == c1) // 2 of a kind
-            && (c2 == c3) && (c2 == c4)) // 3 of a kind
-            return true;
-        
-        // 6,6,6,K,K
-        if ((c0 == c1) && (c0 == c2) // 3 of a kind
-            && (c3 == c4)) // 2 of a kind
-            return true;
-        
-        return false;
-    }
-    bool isFlush(int c0, int c1, int c2, int c3, int c4)
-    {
-        int suit = getSuit(c0);
-        return (suit == getSuit(c1))
-            && (suit == getSuit(c2))
-            && (suit == getSuit(c3))
-            && (suit == getSuit(c4))
-        ;
-    }
-    bool isStraightSimple(int c0, int c1, int c2, int c3, int c4)
-    {
-        if (c0 != (c1 - 1))
-            return false;
-        if (c0 != (c2 - 2))
-            return false;
-        if (c0 != (c3 - 3))
-            return false;
-        if (c0 != (c4 - 4))
-            return false;
-        
-        return true;
-    }
-    bool isStraight(int c0, int c1, int c2, int c3, int c4)
-    {
-        // 5,6,7,8,9
-        // 2,3,4,5,A
-        // 10,J,Q,K,A
-        // straights can't wrap around (2,3,4,K,A is not a straight)
-        if (isStraightSimple(c0, c1, c2, c3, c4))
-            return true;
-
-        if (c0 != 0)
-            return false;
-        if (c4 != 12)
-            return false;
-        
-        if ((c1 == (c0 + 1))
-            && (c2 == (c0 + 2))
-            && (c3 == (c0 + 3)))
-            return true;
-        
-        if ((c4 == (c3 + 1))
-            && (c4 == (c2 + 2))
-            && (c4 == (c1 + 3)))
-            return true;
-        
-        return false;
-    }
-    bool isStraightFlush(int c0, int c1, int c2, int c3, int c4, int cv0, int cv1, int cv2, int cv3, int cv4)
-    {
-        return isFlush(c0, c1, c2, c3, c4) && isStraight(cv0, cv1, cv2, cv3, cv4);
-    }
-    
-    // Three of a kind
-    bool isThreeOfAKind(int c0, int c1, int c2, int c3, int c4)
-    {
-        if ((c0 == c1)
-            && (c0 == c2))
-            return true;
-        
-        if ((c1 == c2)
-            && (c1 == c3))
-            return true;
-        
-        if ((c2 == c3)
-            && (c2 == c4))
-            return true;
-        
-        return false;
-    }
-    // Two pair
-    bool isTwoPairs(int c0, int c1, int c2, int c3, int c4)
-    {
-        if (c0 == c1) // 2,2,3,3,4 or 2,2,3,4,4
-            return ((c2 == c3) || (c3 == c4));
-        
-        if (c1 == c2) // 2,3,3,4,4
-            return (c3 == c4);
-        
-        return false;
-    }
-    // Pairs
-    bool isPair(int c0, int c1, int c2, int c3, int c4)
-    {
-        return (c0 == c1) || (c1 == c2) || (c2 == c3) || (c3 == c4);
-    }
 };
 
-EOSIO_ABI( poker, (search_game)(cancel_game)(start_game)(deck_shuffled)(deck_recrypted)(card_key)(check)(call)(raise)(fold)(dispute)(card_keys)(dispute_step) )
+EOSIO_ABI( poker, (search_game)(cancel_game)(start_game)(deck_shuffled)(deck_recrypted)(card_key)(check)(call)(raise)(fold)(show_hand)(muck)(dispute)(card_keys)(dispute_step) )
@@ -0,0 +1,313 @@
+// Monte Carlo hand strength estimator (native tool for bots and player UI, not a part of the contract)
+//
+// build: g++ -O2 -std=c++14 -pthread tools/equity/equity.cpp -o equity
+// usage: equity <hero cards> [villain cards|-] [board cards|-] [budget ms]
+//   equity AsKd              (random opponent, preflop, 10 ms)
+//   equity AsKd QhQc 2c7hQs  (known opponent on the flop)
+//   equity AsKd - 2c7hQs 50  (random opponent on the flop, 50 ms)
+// cards are written as value + suit: values `23456789TJQKA`, suits `schd` (spades, clubs, hearts, diamonds)
+
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "../../contracts/notechain/handevaluator.hpp"
+
+using namespace hands;
+
+// PCG32 generator (one per worker thread, every worker gets its own stream)
+struct pcg32
+{
+	uint64_t state;
+	uint64_t inc;
+
+	pcg32(uint64_t seed, uint64_t stream)
+		: state(0), inc((stream << 1) | 1)
+	{
+		next();
+		state += seed;
+		next();
+	}
+	uint32_t next()
+	{
+		uint64_t old = state;
+		state = old * 6364136223846793005ULL + inc;
+		uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+		uint32_t rot = (uint32_t)(old >> 59);
+		return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+	}
+	uint32_t bounded(uint32_t n)
+	{
+		// multiply-shift instead of modulo (bias is below 2^-26 for a 52 card deck)
+		return (uint32_t)(((uint64_t)next() * n) >> 32);
+	}
+};
+
+// fixed set of threads started once and reused for every estimate
+class WorkerPool
+{
+  public:
+	static const int MAX_WORKERS = 16;
+
+	WorkerPool(int requested)
+		: count((requested < 1) ? 1 : ((requested > MAX_WORKERS) ? MAX_WORKERS : requested)), generation(0), pending(0), stop(false)
+	{
+		// there is room only for MAX_WORKERS threads
+		for (int i = 0; i < count; i++)
+			workers[i] = std::thread([this, i] { loop(i); });
+	}
+	~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+		}
+		wake.notify_all();
+		for (int i = 0; i < count; i++)
+			workers[i].join();
+	}
+	int size() const { return count; }
+
+	// runs `job(worker_idx)` on every worker and waits until all of them are done
+	void run(std::function<void(int)> task)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		job = task;
+		pending = count;
+		generation++;
+		wake.notify_all();
+		done.wait(lock, [this] { return pending == 0; });
+	}
+
+  private:
+	void loop(int idx)
+	{
+		uint64_t seen = 0;
+		for (;;)
+		{
+			std::function<void(int)> task;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [&] { return stop || (generation != seen); });
+				if (stop)
+					return;
+				seen = generation;
+				task = job;
+			}
+			task(idx);
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				pending--;
+			}
+			done.notify_one();
+		}
+	}
+
+	std::thread workers[MAX_WORKERS];
+	int count;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+	std::function<void(int)> job;
+	uint64_t generation;
+	int pending;
+	bool stop;
+};
+
+struct Spot
+{
+	int hero[2];
+	int villain[2]; // -1 when opponent cards are unknown
+	int board[5];
+	int board_count;
+};
+
+struct Estimate
+{
+	uint64_t samples;
+	uint64_t wins;
+	uint64_t ties;
+	double equity;
+	double ci95; // half-width of 95% confidence interval for equity
+};
+
+// per-worker counters, padded so workers don't share cache lines
+struct alignas(64) Counters
+{
+	uint64_t samples;
+	uint64_t wins;
+	uint64_t ties;
+};
+
+int drawCard(pcg32& rng, uint64_t& dealt)
+{
+	// sample without replacement: retry until we hit a card that is not in the dealt mask
+	for (;;)
+	{
+		int card = rng.bounded(52);
+		uint64_t bit = 1ULL << card;
+		if ((dealt & bit) == 0)
+		{
+			dealt |= bit;
+			return card;
+		}
+	}
+}
+
+Estimate estimate(WorkerPool& pool, const Spot& spot, int budget_ms, uint64_t max_samples)
+{
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(budget_ms);
+	uint64_t quota = max_samples / pool.size() + 1;
+	uint64_t seed = (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+
+	uint64_t known = 0;
+	for (int i = 0; i < 2; i++)
+		known |= 1ULL << spot.hero[i];
+	for (int i = 0; (i < 2) && (spot.villain[0] >= 0); i++)
+		known |= 1ULL << spot.villain[i];
+	for (int i = 0; i < spot.board_count; i++)
+		known |= 1ULL << spot.board[i];
+
+	Counters counters[WorkerPool::MAX_WORKERS];
+	pool.run([&](int idx) {
+		pcg32 rng(seed, idx);
+		Counters local = Counters();
+		while ((local.samples < quota) && (std::chrono::steady_clock::now() < deadline))
+		{
+			// check the clock once per batch, it's more expensive than a sample
+			for (int n = 0; n < 256; n++)
+			{
+				uint64_t dealt = known;
+				int board[5];
+				for (int i = 0; i < spot.board_count; i++)
+					board[i] = spot.board[i];
+				for (int i = spot.board_count; i < 5; i++)
+					board[i] = drawCard(rng, dealt);
+				int villain0 = (spot.villain[0] >= 0) ? spot.villain[0] : drawCard(rng, dealt);
+				int villain1 = (spot.villain[1] >= 0) ? spot.villain[1] : drawCard(rng, dealt);
+
+				int hero_value = getSevenCardValue(board[0], board[1], board[2], board[3], board[4], spot.hero[0], spot.hero[1]);
+				int villain_value = getSevenCardValue(board[0], board[1], board[2], board[3], board[4], villain0, villain1);
+				local.wins += (hero_value > villain_value);
+				local.ties += (hero_value == villain_value);
+			}
+			local.samples += 256;
+		}
+		counters[idx] = local;
+	});
+
+	Estimate result = Estimate();
+	for (int i = 0; i < pool.size(); i++)
+	{
+		result.samples += counters[i].samples;
+		result.wins += counters[i].wins;
+		result.ties += counters[i].ties;
+	}
+	if (result.samples == 0)
+		return result;
+
+	// every sample scores 1 (win), 0.5 (tie) or 0 (loss)
+	double n = (double)result.samples;
+	double mean = (result.wins + 0.5 * result.ties) / n;
+	double mean_sq = (result.wins + 0.25 * result.ties) / n;
+	result.equity = mean;
+	result.ci95 = 1.96 * std::sqrt((mean_sq - mean * mean) / n);
+	return result;
+}
+
+int parseCards(const char* text, int* cards, int max_count)
+{
+	/* parses cards like `AsKd`, returns amount of cards or -1 on error */
+
+	static const char* VALUES = "23456789TJQKA";
+	static const char* SUITS = "schd"; // same order as getSuit
+
+	int len = (int)strlen(text);
+	if ((len % 2 != 0) || (len / 2 > max_count))
+		return -1;
+	for (int i = 0; i < len / 2; i++)
+	{
+		const char* value = strchr(VALUES, text[2 * i]);
+		const char* suit = strchr(SUITS, text[2 * i + 1]);
+		if (!value || !suit || !*value || !*suit)
+			return -1;
+		cards[i] = (int)(suit - SUITS) * 13 + (int)(value - VALUES);
+	}
+	return len / 2;
+}
+
+int main(int argc, char** argv)
+{
+	if ((argc < 2) || (argc > 5))
+	{
+		fprintf(stderr, "usage: %s <hero cards> [villain cards|-] [board cards|-] [budget ms]\n", argv[0]);
+		return 1;
+	}
+
+	Spot spot = Spot();
+	spot.villain[0] = spot.villain[1] = -1;
+	if (parseCards(argv[1], spot.hero, 2) != 2)
+	{
+		fprintf(stderr, "bad hero cards: %s\n", argv[1]);
+		return 1;
+	}
+	if ((argc > 2) && (strcmp(argv[2], "-") != 0) && (parseCards(argv[2], spot.villain, 2) != 2))
+	{
+		fprintf(stderr, "bad villain cards: %s\n", argv[2]);
+		return 1;
+	}
+	if ((argc > 3) && (strcmp(argv[3], "-") != 0))
+	{
+		spot.board_count = parseCards(argv[3], spot.board, 5);
+		if ((spot.board_count < 0) || (spot.board_count == 1) || (spot.board_count == 2))
+		{
+			fprintf(stderr, "bad board cards: %s\n", argv[3]);
+			return 1;
+		}
+	}
+	int budget_ms = (argc > 4) ? atoi(argv[4]) : 10;
+
+	// every card can be used only once
+	uint64_t used = 0;
+	int total = 0;
+	int all[9] = { spot.hero[0], spot.hero[1], spot.villain[0], spot.villain[1] };
+	for (int i = 0; i < spot.board_count; i++)
+		all[4 + i] = spot.board[i];
+	for (int i = 0; i < 4 + spot.board_count; i++)
+	{
+		if (all[i] < 0)
+			continue;
+		used |= 1ULL << all[i];
+		total++;
+	}
+	if (__builtin_popcountll(used) != total)
+	{
+		fprintf(stderr, "same card is used twice\n");
+		return 1;
+	}
+
+	WorkerPool pool((int)std::thread::hardware_concurrency());
+	int threads = pool.size();
+
+	auto started = std::chrono::steady_clock::now();
+	Estimate result = estimate(pool, spot, budget_ms, UINT64_MAX / 2);
+	double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+	if (result.samples == 0)
+	{
+		fprintf(stderr, "no samples in %d ms\n", budget_ms);
+		return 1;
+	}
+	printf("samples: %llu (%d threads, %.1f ms)\n", (unsigned long long)result.samples, threads, elapsed_ms);
+	printf("win:     %.2f%%\n", 100.0 * result.wins / result.samples);
+	printf("tie:     %.2f%%\n", 100.0 * result.ties / result.samples);
+	printf("equity:  %.2f%% +- %.2f%% (95%% confidence)\n", 100.0 * result.equity, 100.0 * result.ci95);
+	return 0;
+}